@@ -0,0 +1,29 @@
+#ifndef CHECK_H_
+#define CHECK_H_
+
+#include <string>
+
+/*
+ * deqn-check: the checks behind make check. Each group is a function run
+ * by check.C; a failed CHECK prints where it was and the run carries on,
+ * exiting non-zero at the end if anything failed.
+ */
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+bool check(bool ok, const char* what, const char* file, int line);
+
+//this process and how many there are, 0 and 1 unless run with mpirun
+int checkRank();
+int checkRanks();
+
+//the prefix for a group's output files <name>.*, in the output directory (-o, default check-output).
+//They are removed once every check has passed and kept for a look otherwise.
+std::string checkOutput(const std::string& name);
+
+void checkStencilKernels();
+void checkAdaptiveTime();
+void checkAdaptiveTimeBlock();
+void checkTimeBlocking();
+void checkSparseTiles();
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef AFFINITY_H_
+#define AFFINITY_H_
+
+#include <string>
+
+/*
+ * Thread pinning, picked with the "thread_affinity" input key:
+ *
+ * - none: leave placement to the OS (the default)
+ * - compact: OpenMP thread t on the t-th CPU the process may run on, so
+ *   neighbouring threads share caches and the first socket fills first
+ * - scatter: threads spread evenly over those CPUs, so with fewer threads
+ *   than CPUs every socket gets its share of threads and memory bandwidth
+ *
+ * CPUs are taken in the order the OS numbers them. OpenMP keeps the same
+ * threads for later teams of the same size, so pinning once before the mesh
+ * is first touched keeps each tile's pages next to the thread computing it.
+ * Threads started afterwards inherit the pinning of the thread that starts
+ * them, so background threads call unpinThread() to run anywhere again.
+ */
+void pinThreads(const std::string& mode, int numThreads);
+void unpinThread();
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "InputFile.h"
+
+/*
+ * Batch mode, deqn -b <batch file>: many problems in one process.
+ *
+ * Small problems do not scale to a full team of threads, so instead of one
+ * problem at a time across every thread, whole problems are handed out to
+ * the threads of one pool, problem_threads threads each (default 1), biggest
+ * first. Each problem writes its output and its log, <name>.log, under its
+ * own name, and the batch writes <batch>.csv (without any .batch extension)
+ * with the time each took.
+ *
+ * The batch file lists the problems, see the README for its format.
+ */
+class Batch {
+    private:
+        struct Problem {
+            std::string name; //output prefix, output_dir included
+            std::string inputFile;
+            std::string settings; //the values a grid varied, key=value;...
+            InputFile input;
+            double cost; //cells times steps, only used to order the problems
+            double seconds;
+        };
+
+        std::string batchName;
+        std::string outputDir;
+        int numThreads;
+        int problemThreads;
+
+        std::vector<Problem> problems;
+
+        //grid being read, expanded when the next grid or input line starts
+        std::string gridFile;
+        std::vector<std::string> varyKeys;
+        std::vector<std::vector<std::string> > varyValues;
+        std::map<std::string, int> gridCounts; //problems so far from each base file, to number them
+
+        void addProblem(const std::string& name, const std::string& inputFile,
+                const std::string& settings, const InputFile& input);
+        void expandGrid();
+    public:
+        Batch(const char* filename);
+
+        //command line and environment settings, the pool size and keys for every problem
+        void setNumThreads(int n);
+        void set(const std::string& name, const std::string& value);
+
+        void run();
+};
+#endif
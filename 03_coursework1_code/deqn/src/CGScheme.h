@@ -0,0 +1,30 @@
+#ifndef CG_SCHEME_H_
+#define CG_SCHEME_H_
+
+#include "ImplicitScheme.h"
+#include "Multigrid.h"
+
+/*
+ * Backward Euler solved with preconditioned conjugate gradients. The
+ * preconditioner (input key "preconditioner") is a multigrid V-cycle (mg,
+ * the default) or nothing (none). With mg the iteration count barely grows
+ * with dt, so steps far beyond the explicit stability limit stay cheap.
+ */
+class CGScheme : public ImplicitScheme {
+    private:
+        Multigrid* multigrid; //NULL without a preconditioner
+
+        double** r; //residual
+        double** z; //preconditioned residual
+        double** p; //search direction
+        double** q; //A p
+
+        void applyOperator(double** y, double** x, double rx, double ry);
+
+        int solve(double** x, double** b, double rx, double ry, double& residual);
+        const char* getName();
+    public:
+        CGScheme(const InputFile* input, Mesh<DoublePrecision>* m);
+        ~CGScheme();
+};
+#endif
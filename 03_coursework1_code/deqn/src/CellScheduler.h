@@ -0,0 +1,43 @@
+#ifndef CELL_SCHEDULER_H_
+#define CELL_SCHEDULER_H_
+
+#include <atomic>
+
+/*
+ * Hands out mesh cells (tiles) to the threads of an OpenMP team.
+ *
+ * Every thread starts with a contiguous block of cells which it takes from
+ * the front. Once its own block is empty it steals half of the remaining
+ * cells from the back of another thread's block, so there can be many more
+ * cells than threads without any thread sitting idle. Without stealing
+ * (pin_tiles) a cell is always done by the thread whose block it is in, so
+ * it stays in that thread's cache and on its NUMA node.
+ *
+ * reset() must be called (outside of the parallel region) before each sweep.
+ */
+class CellScheduler {
+    private:
+        // one queue per thread, padded to stop false sharing between threads
+        struct alignas(64) Queue {
+            std::atomic<unsigned long long> range; //begin in high word, end in low word
+        };
+
+        Queue* queues;
+
+        int numCells;
+        int numThreads;
+        bool steal;
+
+        bool popFront(int thread, int& cell);
+        bool stealBack(int victim, int& begin, int& end);
+    public:
+        CellScheduler(int numCells, int numThreads, bool steal = true);
+        ~CellScheduler();
+
+        void reset();
+        int nextCell(int thread); //returns -1 once every cell has been handed out
+
+        int getOwner(int cell); //thread whose block a cell starts in
+        int getNumThreads();
+};
+#endif
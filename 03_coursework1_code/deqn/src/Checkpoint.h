@@ -0,0 +1,85 @@
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <stdint.h>
+#include <string>
+#include <thread>
+
+#include "InputFile.h"
+#include "Mesh.h"
+
+//cell data starts here in the file, so it is page aligned whatever the header holds
+#define CHECKPOINT_DATA_OFFSET 4096
+#define CHECKPOINT_VERSION 2
+
+struct CheckpointHeader {
+    char magic[8]; //"DEQNCHK\0"
+    uint32_t byteOrder; //0x01020304 as written, to catch files from another endianness
+    int32_t version;
+
+    //layout of the cells, all must match the mesh that restores it
+    int32_t nx;
+    int32_t ny;
+    int32_t cellSizeX;
+    int32_t cellSizeY;
+    int32_t halo;
+    int32_t numCells;
+    int32_t divisionsX;
+    int32_t divisionsY;
+    int32_t rank;
+    int32_t numRanks;
+    int32_t localMinY;
+    int32_t localNy;
+    int32_t realSize; //bytes per value, 4 for float and mixed precision
+
+    //where the run was
+    int64_t step;
+    double time;
+    double dt;
+
+    uint64_t dataOffset;
+    uint64_t dataLength; //bytes of cell data
+};
+
+/*
+ * Checkpoint and restart.
+ *
+ * A checkpoint is one file per rank, <checkpoint_file>.chk (with the rank
+ * before .chk under MPI), holding a header and then every cell of u0 as it
+ * is in memory, halo included. write() only copies u0 into a staging buffer;
+ * a background thread writes it to a .tmp file, syncs it, renames it over
+ * the last checkpoint and syncs the directory, so a crash at any point
+ * leaves either the previous checkpoint or the new one.
+ *
+ * restore() maps the file privately and hands the cells straight to the
+ * mesh, so there is no parsing and no copy: the whole file is read in at
+ * restore (with MAP_POPULATE; without it, as the first step touches each
+ * page) and pages are copied only when written. The mapping is unmapped
+ * when the checkpoint is destroyed, so it must not go before the mesh is
+ * done with.
+ */
+template <typename P>
+class Checkpoint {
+    private:
+        typedef typename P::Real Real;
+
+        Mesh<P>* mesh;
+        std::string fileName;
+
+        char* buffer; //header page then cell data, page aligned
+        long length;
+        void* mapping; //of the restored file, the mesh's cells live in it until the checkpoint goes
+
+        std::thread thread;
+
+        void fillHeader(CheckpointHeader* header);
+        void writeFile();
+    public:
+        Checkpoint(const InputFile* input, Mesh<P>* mesh, const std::string& problem_name);
+        ~Checkpoint();
+
+        void write(int step, double time, double dt); //time and dt to carry on with
+        void restore(int& step, double& time, double& dt);
+        void finish(); //waits for the last write
+};
+#endif
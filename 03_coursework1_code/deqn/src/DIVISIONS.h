@@ -1,7 +0,0 @@
-#ifndef DIVISIONS_H
-#define DIVISIONS_H
-
-#define DIVISIONS 4
-#define NUM_CELLS (DIVISIONS * DIVISIONS)
-
-#endif
@@ -7,19 +7,22 @@
 
 #include <vector>
 
+template <typename P>
 class Diffusion {
     private:
-        Mesh* mesh;
+        Mesh<P>* mesh;
 
-        Scheme* scheme;
+        Scheme<P>* scheme;
 
         std::vector<double> subregion;
     public:
-        Diffusion(const InputFile* input, Mesh* m);
+        Diffusion(const InputFile* input, Mesh<P>* m);
 
         ~Diffusion();
 
         void init();
-        void doCycle(const double dt);
+        void doCycle(const double dt, const int steps = 1);
+        int getBlockSteps();
+        double getMaxStableDt();
 };
 #endif
@@ -7,13 +7,19 @@
 #include "InputFile.h"
 #include "Mesh.h"
 #include "VtkWriter.h"
+#include "SnapshotWriter.h"
+#include "Checkpoint.h"
 
+//P is the precision mode (see Precision.h), main picks it from the input file
+template <typename P>
 class Driver {
     private:
         InputFile* input;
-        Mesh* mesh;
-        Diffusion* diffusion;
-        VtkWriter* writer;
+        Mesh<P>* mesh;
+        Diffusion<P>* diffusion;
+        VtkWriter<P>* writer;
+        SnapshotWriter<P>* output;
+        Checkpoint<P>* checkpoint;
 
         double t_start;
         double t_end;
@@ -21,16 +27,37 @@ class Driver {
 
         double dt;
 
+        //timestep control, see the README
+        bool adaptive;
+        double cfl;
+        double dt_tolerance;
+        double dt_stable; //0 for implicit schemes
+        double steady_tolerance;
+
+        bool profile; //write a trace and summary at the end (needs a PROFILE build)
+
+        void updateDt(double change);
+
         std::string problem_name;
 
         int vis_frequency;
         int summary_frequency;
+        bool summary_stats; //min, max and max change with the total temperature
+        int histogram_bins;
+        int checkpoint_frequency;
+
+        int start_count; //steps already taken when restarting from a checkpoint
     public:
         Driver(const InputFile* input, const std::string& problem_name);
 
         ~Driver();
 
-        void writeVtks(int start, int count); //added
         void run();
 };
+
+//the input file name without its directory or .in, the output is named after it
+std::string problemName(const std::string& filename);
+
+//runs one problem in the precision its input file asks for
+void runProblem(const InputFile* input, const std::string& problem_name);
 #endif
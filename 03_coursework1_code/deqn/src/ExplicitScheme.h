@@ -3,22 +3,66 @@
 
 #include "Scheme.h"
 #include "InputFile.h"
+#include "StencilKernel.h"
 
-class ExplicitScheme : public Scheme {
+#include <vector>
+
+template <typename P>
+class ExplicitScheme : public Scheme<P> {
     private:
-        Mesh* mesh;
+        typedef typename P::Real Real;
+
+        Mesh<P>* mesh;
+
+        int blockSteps; //steps per halo exchange (temporal blocking)
+        Real** scratch; //two cells per thread for intermediate steps
+
+        CellScheduler** haloSchedulers;
+
+        //with several ranks the cells next to other ranks are done first (see doAdvance)
+        std::vector<int> edgeCells;
+        std::vector<int> innerCells;
+        CellScheduler* edgeScheduler;
+        CellScheduler* edgeHaloScheduler;
+        CellScheduler* innerScheduler;
+
+        typename StencilKernel<Real>::RowFn stencilRow; //picked at startup for the CPU
+
+        /*
+         * Sparse tiles (sparse_tiles, on by default). Heat spreads out from
+         * wherever it starts, so early on most cells are exactly zero and
+         * stay so. A cell is hot once its interior has held a non-zero value
+         * and active while it or any of its eight neighbours is hot; only
+         * active cells are computed and have their halos filled. Inactive
+         * cells are kept zero in both frames, which is exactly what computing
+         * them would give, so results are identical to the dense sweep.
+         * Cells next to other ranks are always active. Once every cell is
+         * active tracking stops, and it starts again after init().
+         */
+        bool sparseTiles;
+        bool tracking; //skipping inactive cells
+        bool trackingStarted; //hot and active are for the data in the mesh
+        std::vector<char> hot; //never cleared, so activation only grows
+        std::vector<char> active;
+        int numActive;
 
-        void updateBoundaries();
-        void advance(); //replaces reset
-        void diffuse(double dt);
-        void reflectBoundaries(int cell, int boundary_id);
+        void startTracking(Real** u0, Real** u1);
+        void activate(); //by one thread, after every cell of a sweep is done
+        bool isIdle(int cell);
 
-        //void talkToSurroundingCells(int cell);
-        void getNeighbourCellData(int cell, int boundary_id);
+        void updateBoundaries(Real** u);
+        void updateBoundaries(Real** u, int thread, bool exchange); //inside a parallel region
+        void advance(int steps); //replaces reset
+        void computeCell(int cell, int thread, double rx, double ry, int steps, Real** u0, Real** u1);
+        void diffuse(int cell, int thread, double rx, double ry, int steps, Real** u0, Real** u1);
+        void doAdvanceDistributed(double rx, double ry, int steps, Real** u0, Real** u1);
     public:
-        ExplicitScheme(const InputFile* input, Mesh* m);
+        ExplicitScheme(const InputFile* input, Mesh<P>* m);
+        ~ExplicitScheme();
 
-        void doAdvance(const double dt);
+        void doAdvance(const double dt, const int steps);
+        int getBlockSteps();
+        double getMaxStableDt();
 
         void init();
 };
@@ -0,0 +1,54 @@
+#ifndef IMPLICIT_SCHEME_H_
+#define IMPLICIT_SCHEME_H_
+
+#include "Scheme.h"
+#include "InputFile.h"
+
+/*
+ * Base of the backward Euler schemes. Every step solves
+ *
+ *   (1 + 2rx + 2ry) u1[i][j] - rx (u1[i][j-1] + u1[i][j+1]) - ry (u1[i-1][j] + u1[i+1][j]) = u0[i][j]
+ *
+ * with the same reflective boundaries as the explicit scheme, so there is
+ * no stability limit on dt. Vectors are stored cell by cell exactly like u0
+ * and u1 (halos and all), so Mesh::updateHalo works on them too.
+ *
+ * Reductions are summed per cell and then over the cells in order, so the
+ * results do not depend on the number of threads.
+ *
+ * The implicit schemes only run in double precision (see Precision.h).
+ */
+class ImplicitScheme : public Scheme<DoublePrecision> {
+    protected:
+        Mesh<DoublePrecision>* mesh;
+
+        double tolerance; //on the residual, relative to the right hand side
+        int maxIterations;
+
+        int totalIterations;
+        int numSolves;
+
+        double* cellPartials; //one reduction partial per cell
+
+        CellScheduler* haloScheduler;
+
+        double** allocateVector();
+        void freeVector(double** v);
+
+        void updateBoundaries(double** u);
+        void copy(double** dst, double** src);
+        double dot(double** a, double** b);
+        double sumPartials();
+
+        //solves A x = b, x holds the initial guess, returns the iterations taken
+        virtual int solve(double** x, double** b, double rx, double ry, double& residual) = 0;
+        virtual const char* getName() = 0;
+    public:
+        ImplicitScheme(const InputFile* input, Mesh<DoublePrecision>* m);
+        virtual ~ImplicitScheme();
+
+        void doAdvance(const double dt, const int steps);
+
+        void init();
+};
+#endif
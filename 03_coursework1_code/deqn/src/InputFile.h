@@ -13,6 +13,7 @@ class InputFile {
                 const std::string& name,
                 const T& dfault) const;
     public:
+        InputFile(); //empty, filled in with set()
         InputFile(const char* filename);
         ~InputFile();
 
@@ -31,5 +32,13 @@ class InputFile {
         std::vector<double> getDoubleList(
                 const std::string& name,
                 const std::vector<double>& dfault) const;
+
+        //whether the key was given at all, to tell a default from an explicit value
+        bool has(const std::string& name) const;
+
+        //override (or add) a key, used for command line/environment settings
+        void set(
+                const std::string& name,
+                const std::string& value);
 };
 #endif
@@ -0,0 +1,21 @@
+#ifndef JACOBI_SCHEME_H_
+#define JACOBI_SCHEME_H_
+
+#include "ImplicitScheme.h"
+
+/*
+ * Backward Euler solved with matrix-free Jacobi iterations. Simple and
+ * cheap per iteration, but the iteration count grows with rx and ry, so
+ * for large timesteps the cg scheme converges much faster.
+ */
+class JacobiScheme : public ImplicitScheme {
+    private:
+        double** work; //the other Jacobi iterate
+
+        int solve(double** x, double** b, double rx, double ry, double& residual);
+        const char* getName();
+    public:
+        JacobiScheme(const InputFile* input, Mesh<DoublePrecision>* m);
+        ~JacobiScheme();
+};
+#endif
@@ -0,0 +1,16 @@
+#ifndef LOG_H_
+#define LOG_H_
+
+#include <ostream>
+
+/*
+ * Where a run reports its progress. This is std::cout unless the thread
+ * running the problem has been given a stream of its own, as each problem
+ * in a batch is, so concurrent problems do not interleave their logs.
+ *
+ * Only the thread that owns the Driver logs, never the OpenMP workers.
+ */
+std::ostream& runLog();
+void setRunLog(std::ostream* stream); //for the calling thread, NULL goes back to std::cout
+
+#endif
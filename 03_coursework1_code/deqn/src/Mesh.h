@@ -2,15 +2,72 @@
 #define DIFFUSION_MESH_H_
 
 #include "InputFile.h"
+#include "CellScheduler.h"
+#include "Precision.h"
+#include "StencilKernel.h"
+#include "TileArena.h"
 
+#include <vector>
+
+#ifdef HAVE_MPI
+#include <mpi.h>
+#endif
+
+//cell rows are padded and aligned to this many bytes (one cache line / AVX-512 vector)
+#define ROW_ALIGN_BYTES 64
+
+/*
+ * P is one of the precision modes in Precision.h: frames are stored as
+ * P::Real, positions and the other geometry are always double.
+ */
+template <typename P>
 class Mesh {
+    public:
+        typedef typename P::Real Real;
+        typedef typename P::Accum Accum;
     private:
         const InputFile* input;
 
-        double*** uX; //pointer to array of frames, each frame array of cells
-        int numFrames; //need for array length
-        int currentFrame;
-        int* cellSize;
+        Real*** uX; //u0 and u1, each frame array of cells
+        TileArena* arena; //holds every cell of both frames
+        int currentFrame; //number of advances, picks which of uX is u0
+        int currentStep; //number of timesteps taken
+        int* cellSize; //allocated size of every cell including halo (x is the row stride)
+        int halo; //depth of the halo around every cell
+
+        /*
+         * The mesh is split into cells (tiles) of tile_nx * tile_ny physics
+         * cells. Cells in the last column/row are smaller when nx/ny is not
+         * a multiple of the tile size, so no physics cells are dropped.
+         */
+        int numThreads;
+        int numCells;
+        int* divisions; //number of cells in x and y
+        int* cellNx; //interior size of each cell
+        int* cellNy;
+        int* cellMinX; //global index of first interior physics cell (0 based)
+        int* cellMinY;
+
+        CellScheduler* scheduler;
+        bool pinTiles; //no work stealing, a cell is always computed by the thread that first touched it
+
+        /*
+         * With MPI the rows of cells are split into slabs, one per rank, and
+         * a rank only holds the cells of its own slab. Cell numbers, divisions
+         * and the frames are all local to the slab; cellMinX/cellMinY and the
+         * positions stay global. Without MPI there is one rank holding everything.
+         */
+        int rank;
+        int numRanks;
+        int localMinY; //first global row of physics cells in this rank's slab
+        int localNy;
+
+        //edge rows of the slab, sent to and received from the ranks above/below
+        std::vector<Real> sendTop, sendBottom, recvTop, recvBottom;
+#ifdef HAVE_MPI
+        MPI_Request requests[4];
+        int numRequests;
+#endif
 
         double** posX; //in each cell
         double** posY;
@@ -22,14 +79,39 @@ class Mesh {
 
         int NDIM;
 
-        int* n; 
+        int* n;
         int* min;
         int* max;
 
         double* dx;
 
         /*
-         * A mesh has four neighbours, and they are 
+         * Reductions of a frame are kept per cell and combined in cell order,
+         * over every rank, so they come out the same whatever the number of
+         * threads or ranks. A scheme that asks for them (getStatsWanted) fills
+         * them in with reduceRow while each row it writes is still in cache;
+         * otherwise the first query makes one pass over u0 (computeStats).
+         */
+        struct CellStats {
+            Accum sum; //compensated, sumError is what has been lost
+            Accum sumError;
+            Real min;
+            Real max;
+            Real maxChange; //against the frame before
+        };
+        std::vector<CellStats> cellStats;
+        std::vector<long> cellHistogram; //histogramBins counts per cell
+        int statsFrame; //frame the stats are for, -1 if none
+        bool statsWanted;
+        int histogramBins;
+        double histogramMin;
+        double histogramScale; //bins per unit
+        typename StencilKernel<Real>::ReduceFn reduceKernel; //for the same simd as the stencil
+
+        void computeStats();
+
+        /*
+         * A mesh has four neighbours, and they are
          * accessed in the following order:
          * - top
          * - right
@@ -39,12 +121,25 @@ class Mesh {
 
         void allocate();
         bool allocated;
+
+        void getNeighbourCellData(Real** u, int cell, int boundary_id, bool corners);
+        void packRows(Real** u, int cellRow, int firstRow, std::vector<Real>& buffer);
+        void unpackRows(Real** u, int cellRow, int firstRow, const std::vector<Real>& buffer);
+        void reflectBoundaries(Real** u, int cell, int boundary_id);
     public:
+        enum HaloPhase { HALO_ALL, HALO_X, HALO_Y };
+
+        //values per aligned row chunk, the row stride is a multiple of this
+        static const int ROW_ALIGN = ROW_ALIGN_BYTES / sizeof(Real);
+
+        //aligned storage for a cell, free with free()
+        static Real* allocateCell(long length);
+
         Mesh(const InputFile* input);
-                
-        double** getU0();
-        double** getU1();
-        double** getUX(int frame); //my function
+        ~Mesh();
+
+        Real** getU0();
+        Real** getU1();
 
         double* getDx();
         int* getNx();
@@ -61,13 +156,81 @@ class Mesh {
 
         int* getNeighbours();
 
+        //reductions of u0 over every rank, see above
         double getTotalTemperature();
+        double getMinTemperature();
+        double getMaxTemperature();
+        double getMaxChange(); //between u0 and the frame before it
+        std::vector<long> getHistogram(); //bins equal width over [lo, hi], outliers in the end bins
+        void setHistogram(int bins, double lo, double hi);
+
+        /*
+         * Fused reductions. When getStatsWanted(), a scheme calls beginCellStats
+         * and then reduceRow for every interior row of each cell of the frame it
+         * writes (previous is the same row of u0), then markStatsCurrent after
+         * advance(). Set per step by whoever needs the reductions.
+         */
+        void setStatsWanted(bool wanted);
+        bool getStatsWanted();
+        void beginCellStats(int cell);
+        void reduceRow(int cell, const Real* row, const Real* previous, int n);
+        void zeroCellStats(int cell); //instead of both, for a cell that is zero in both frames
+        void markStatsCurrent();
+        void resetStats(); //the next query makes a pass, for benchmarks
 
         //my added functions
-        void advance();
+        void advance(int steps = 1);
         int getCurrentFrame();
+        int getCurrentStep();
+        void gather(Real* u); //u0 interior of this rank's slab into a nx * localNy row major array
         int* getCellSize();
 
+        /*
+         * Checkpoints (see Checkpoint.h) store every cell of u0 whole, halo
+         * included, back to back. restore() makes u0 point straight at such a
+         * block of memory (the cells must stay 64 byte aligned) and carries on
+         * from step; the old u0 cells are left unused in the arena.
+         */
+        long getCellLength(); //values in a cell including halo
+        void restore(Real* cells, int step);
+
+        //cell decomposition, interior of a cell starts at (halo, halo)
+        int getHalo();
+        int getNumThreads();
+        int getNumCells();
+        int* getDivisions();
+        int getCellNx(int cell);
+        int getCellNy(int cell);
+        int getCellMinX(int cell);
+        int getCellMinY(int cell);
+        CellScheduler* getScheduler();
+        bool getPinTiles(); //for schedulers of the mesh's cells made elsewhere
+
+        //zeroes every cell of u from the thread that owns it, so its pages are on that thread's NUMA node
+        void firstTouch(Real** u);
+
+        //distributed memory, see above
+        int getRank();
+        int getNumRanks();
+        int getLocalMinY();
+        int getLocalNy();
+        double globalSum(double value);
+        double globalMax(double value);
+
+        //halo exchange, boundary ids are in the order above
+        bool hasNeighbour(int cell, int boundary_id); //local or on another rank
+        bool isRemoteNeighbour(int cell, int boundary_id);
+        void updateHalo(Real** u, int cell, HaloPhase phase); //leaves halos from other ranks alone
+
+        /*
+         * Fills the top/bottom halos that come from other ranks. Called by one
+         * thread only (MPI is initialised FUNNELED), start after the edge rows of
+         * u are final, and finish before those halos are used. With halos deeper
+         * than 1 the edge cells must have had HALO_X done, so the corners go too.
+         */
+        void startHaloExchange(Real** u);
+        void finishHaloExchange(Real** u);
+
         //index translation functions, will be called as little as possible as not very fast, (get original index)
         int getOI(int cell, int index);
         int getOIi(int cell, int index);
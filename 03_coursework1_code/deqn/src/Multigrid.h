@@ -0,0 +1,50 @@
+#ifndef MULTIGRID_H_
+#define MULTIGRID_H_
+
+#include "InputFile.h"
+#include "Mesh.h"
+
+/*
+ * Geometric multigrid V-cycle, used as the preconditioner of the cg scheme.
+ *
+ * Levels are plain row major arrays with a one cell ghost ring, each half
+ * the size of the one above (the last cell takes the odd one out). Coarse
+ * operators are the backward Euler operator rediscretised on the coarse
+ * spacing, residuals are restricted by summing the four children over 4,
+ * corrections are prolongated piecewise constant, and the smoother is
+ * damped Jacobi. Pre and post smoothing are the same, so the V-cycle is a
+ * symmetric operator as cg needs.
+ *
+ * Input keys: mg_levels (default: coarsen while both sides are at least 8)
+ * and mg_smooth (sweeps before and after each coarse correction, default 2).
+ */
+class Multigrid {
+    private:
+        Mesh<DoublePrecision>* mesh;
+
+        int numLevels;
+        int smoothSteps;
+        int numThreads;
+
+        int* nx; //interior size of each level
+        int* ny;
+        double* rx; //operator of each level, set by setOperator()
+        double* ry;
+
+        double** x; //solution, right hand side and work array of each level
+        double** b;
+        double** tmp;
+
+        void reflect(int level, double* u);
+        void smooth(int level, int steps);
+        void vcycle(int level);
+    public:
+        Multigrid(const InputFile* input, Mesh<DoublePrecision>* mesh);
+        ~Multigrid();
+
+        int getNumLevels();
+
+        void setOperator(double rx, double ry);
+        void apply(double** z, double** r); //z = M r, both stored in cells like u0
+};
+#endif
@@ -0,0 +1,42 @@
+#ifndef PRECISION_H_
+#define PRECISION_H_
+
+/*
+ * Precision modes, picked with the "precision" input key. Real is what the
+ * frames and snapshots are stored in, Accum what reductions (total
+ * temperature, max change) add up in.
+ *
+ * - double: everything in double (the default)
+ * - float: everything in float, half the memory traffic of double
+ * - mixed: float storage, double reductions, so sums over big meshes do
+ *   not lose the small contributions
+ *
+ * Mesh, the explicit scheme, Diffusion and the writers are templates on one
+ * of these, instantiated for all three in their .C files, so the mode is
+ * chosen once in main and the hot loops have no branches on it.
+ */
+struct DoublePrecision {
+    typedef double Real;
+    typedef double Accum;
+    static const char* getName() { return "double"; }
+};
+
+struct FloatPrecision {
+    typedef float Real;
+    typedef float Accum;
+    static const char* getName() { return "float"; }
+};
+
+struct MixedPrecision {
+    typedef float Real;
+    typedef double Accum;
+    static const char* getName() { return "mixed"; }
+};
+
+//explicit instantiation of a class template for every mode, at the end of its .C file
+#define INSTANTIATE_PRECISIONS(name) \
+    template class name<DoublePrecision>; \
+    template class name<FloatPrecision>; \
+    template class name<MixedPrecision>;
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <string>
+
+/*
+ * Scoped timers and counters for the hot paths.
+ *
+ * Built in with -DPROFILE (see the Makefile), otherwise PROFILE_SCOPE and
+ * PROFILE_COUNT compile to nothing. When built in, recording is switched on
+ * with the "profile" input key; while off each timer costs one branch.
+ *
+ * Every thread (OpenMP or output writer) records into its own log, so
+ * recording never takes a lock. At the end of a run the logs are written
+ * as a Chrome trace (load it in chrome://tracing or Perfetto) and summed
+ * into a table per timer and per thread.
+ */
+class Profiler {
+    public:
+        static void enable(int maxEvents);
+        static bool isEnabled();
+
+        static double now(); //seconds since enable()
+        static void record(const char* name, double start, double end);
+        static void count(const char* name, long n);
+
+        static void writeTrace(const std::string& fileName);
+        static void printSummary();
+};
+
+class ProfileScope {
+    private:
+        const char* name;
+        double start;
+    public:
+        ProfileScope(const char* name) :
+            name(name),
+            start(Profiler::isEnabled() ? Profiler::now() : -1.0)
+        {
+        }
+
+        ~ProfileScope()
+        {
+            if (start >= 0.0)
+                Profiler::record(name, start, Profiler::now());
+        }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef PROFILE
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_COUNT(name, n) do { if (Profiler::isEnabled()) Profiler::count(name, n); } while (0)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_COUNT(name, n)
+#endif
+
+#endif
@@ -3,11 +3,21 @@
 
 #include "Mesh.h"
 
+template <typename P>
 class Scheme {
     private:
-        Mesh* mesh;
+        Mesh<P>* mesh;
     public:
-        virtual void doAdvance(const double dt) = 0;
+        virtual ~Scheme() {}
+
+        //advance steps timesteps, steps is never more than getBlockSteps()
+        virtual void doAdvance(const double dt, const int steps) = 0;
+
+        //number of timesteps the scheme can take in one go
+        virtual int getBlockSteps() { return 1; }
+
+        //largest stable timestep, 0 if the scheme is unconditionally stable
+        virtual double getMaxStableDt() { return 0.0; }
 
         virtual void init() = 0;
 };
@@ -0,0 +1,57 @@
+#ifndef SNAPSHOT_WRITER_H_
+#define SNAPSHOT_WRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "InputFile.h"
+#include "Mesh.h"
+#include "VtkWriter.h"
+
+template <typename Real>
+struct Snapshot {
+    Real* u; //nx * localNy values of this rank's slab, row major
+    int step;
+    double time;
+};
+
+/*
+ * Writes visualisation output in the background while the solver carries on.
+ *
+ * Snapshots come from a fixed pool of output_buffers frames. The solver
+ * takes a free one, copies the mesh into it and hands it over, and one of
+ * output_threads writer threads writes it out and puts it back in the pool.
+ * When every frame is still waiting to be written, write() blocks until one
+ * is free, so memory stays bounded however long the run is.
+ */
+template <typename P>
+class SnapshotWriter {
+    private:
+        typedef typename P::Real Real;
+
+        Mesh<P>* mesh;
+        VtkWriter<P>* writer;
+
+        std::vector<Snapshot<Real> > pool;
+        std::deque<Snapshot<Real>*> freeSnapshots;
+        std::deque<Snapshot<Real>*> pendingSnapshots;
+
+        std::mutex lock;
+        std::condition_variable freeAvailable;
+        std::condition_variable pendingAvailable;
+
+        std::vector<std::thread> threads;
+        bool finished;
+
+        void writerLoop();
+    public:
+        SnapshotWriter(const InputFile* input, Mesh<P>* mesh, VtkWriter<P>* writer);
+        ~SnapshotWriter();
+
+        void write(int step, double time); //snapshot of the current u0
+        void finish(); //waits for everything to be written
+};
+#endif
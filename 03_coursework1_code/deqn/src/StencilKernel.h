@@ -0,0 +1,44 @@
+#ifndef STENCIL_KERNEL_H_
+#define STENCIL_KERNEL_H_
+
+#include <string>
+
+/*
+ * Row kernels for the explicit five point stencil. Each computes
+ *
+ *   dst[j] = c*src[j] + rx*src[j-1] + rx*src[j+1] + ry*src[j-stride] + ry*src[j+stride]
+ *
+ * for j in [0, n), with the operations in exactly that order so every
+ * variant gives bit-identical results to the scalar one.
+ *
+ * The variant is picked once at startup from the CPU features, or forced
+ * with the "simd" input key (auto, avx512, avx2, sse2, scalar). There is a
+ * set for each storage type, Real is float or double.
+ *
+ * Alongside each there is a reduce kernel for the fused reductions in Mesh,
+ * run on a row straight after it is written. It finds the sum (always in
+ * double), min and max of a row and its largest change from the row before.
+ * The sum is split across the vector lanes, which are added pairwise at the
+ * end, so a given kernel always sums a row the same way.
+ */
+template <typename Real>
+struct RowStats {
+    double sum;
+    Real min;
+    Real max;
+    Real maxChange;
+};
+
+template <typename Real>
+class StencilKernel {
+    public:
+        typedef void (*RowFn)(Real* dst, const Real* src, int stride, int n,
+                Real c, Real rx, Real ry);
+        typedef void (*ReduceFn)(const Real* row, const Real* previous, int n,
+                RowStats<Real>* stats);
+
+        static RowFn select(const std::string& isa);
+        static ReduceFn selectReduce(const std::string& isa);
+        static const char* getName(RowFn fn);
+};
+#endif
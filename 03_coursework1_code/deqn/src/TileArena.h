@@ -0,0 +1,46 @@
+#ifndef TILE_ARENA_H_
+#define TILE_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+/*
+ * Memory for the frames of a mesh. Rather than a heap allocation per cell,
+ * cells are carved out of a few large blocks mapped straight from the
+ * kernel, and all of it is released together when the arena goes.
+ *
+ * Mapped pages are not backed until they are first written, and on a NUMA
+ * machine they are then placed on the node of the thread that wrote them.
+ * So nothing here touches the memory: the mesh writes each cell first from
+ * the thread that will compute it (see Mesh::allocate), and page() lets it
+ * keep cells of different threads off the same page.
+ *
+ * With hugePages the blocks are 2MB aligned and advised as transparent huge
+ * pages (huge_pages input key), which cuts TLB misses on big meshes. It is
+ * only advice, the kernel may still use small pages.
+ */
+class TileArena {
+    private:
+        struct Block {
+            char* base;
+            size_t length;
+            size_t used;
+        };
+
+        std::vector<Block> blocks;
+        bool hugePages;
+
+        void newBlock(size_t minLength);
+    public:
+        TileArena(bool hugePages);
+        ~TileArena();
+
+        //bytes from the current block, alignment must be a power of two
+        void* allocate(size_t bytes, size_t alignment);
+
+        //the next allocation starts on a new page
+        void page();
+
+        static size_t pageSize(bool hugePages);
+};
+#endif
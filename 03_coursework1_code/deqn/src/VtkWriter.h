@@ -1,21 +1,58 @@
 #ifndef VTKWRITER_H_
 #define VTKWRITER_H_
 
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "InputFile.h"
 #include "Mesh.h"
 
+/*
+ * Output formats, picked with output_format:
+ * - vtk: legacy ASCII rectilinear grid (the default)
+ * - vtk_binary: legacy binary rectilinear grid, big-endian as VTK requires
+ * - vti: VTK XML image data with the field as raw appended data, plus a .pvd
+ *   collection. output_compression zlib compresses the field with
+ *   vtkZLibDataCompressor blocks (needs HAVE_ZLIB).
+ *
+ * The field is written in the mesh's storage type (double or float), time
+ * and coordinates as before. writeVtk() can be called from several writer
+ * threads at once.
+ */
+template <typename P>
 class VtkWriter {
     private:
+        typedef typename P::Real Real;
+
+        enum Format { VTK_ASCII, VTK_BINARY, VTI };
+
         std::string dump_basename;
 
         std::string vtk_header;
 
-        Mesh* mesh;
+        Mesh<P>* mesh;
+
+        Format format;
+        bool compress;
+        int compressionLevel;
+
+        //steps written so far, for the .pvd collection
+        std::mutex writtenLock;
+        std::vector<std::pair<int, double> > written;
+
+        std::string fileName(int step, int block); //blocks are ranks, numbered from 1 in the name
+        const char* extension();
 
+        void writeAscii(std::ofstream& file, int step, double time, const Real* u);
+        void writeBinary(std::ofstream& file, int step, double time, const Real* u);
+        void writeVti(std::ofstream& file, int step, double time, const Real* u);
+        void writePvd();
     public:
-        VtkWriter(std::string basename, Mesh* mesh);
+        VtkWriter(std::string basename, Mesh<P>* mesh, const InputFile* input);
 
         void writeVisit(int stepMax);
-        void writeVtk(int step, double time);
+        void writeVtk(int step, double time, const Real* u);
 };
 #endif